@@ -0,0 +1,314 @@
+/*
+  ==============================================================================
+
+    Double precision reference of the all pass ladder and conformance checks
+    that compare MultiAllPassEngine against it. No JUCE dependency.
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "MultiAllPassConformance.h"
+
+//==============================================================================
+namespace
+{
+	// Expose the coefficients of the shipped filters
+	class FirstOrderCoefficients : public FirstOrderAllPass
+	{
+	public:
+		float getA1() const { return m_a1; }
+	};
+
+	class SecondOrderCoefficients : public SecondOrderAllPass
+	{
+	public:
+		float getA0() const { return m_a0; }
+		float getA1() const { return m_a1; }
+	};
+}
+
+//==============================================================================
+MultiAllPassReference::MultiAllPassReference()
+{
+}
+
+void MultiAllPassReference::prepare(double sampleRate, int channels)
+{
+	m_SampleRate = (int)(sampleRate);
+	m_channels = channels;
+
+	m_firstOrderAllPass.assign(MultiAllPassEngine::N_ALL_PASS_FO * channels, FirstOrderState());
+	m_secondOrderAllPass.assign(MultiAllPassEngine::N_ALL_PASS_SO * channels, SecondOrderState());
+}
+
+void MultiAllPassReference::setParams(const MultiAllPassEngine::Params& params)
+{
+	m_params = MultiAllPassEngine::sanitiseParams(params);
+}
+
+// Coefficients come from the shipped float filters, the ladder recursion and output gain run in double.
+// Near unit circle poles make the ladder very sensitive to coefficient rounding, so recomputing the
+// coefficients in double would measure that rounding instead of the process chain.
+void MultiAllPassReference::process(double* const* channelData, int samples)
+{
+	const float frequency = m_params.frequency;
+	const double volume = pow(10.0, m_params.volume / 20.0);
+
+	for (int channel = 0; channel < m_channels; ++channel)
+	{
+		double* channelBuffer = channelData[channel];
+
+		if (m_params.mode == MultiAllPassEngine::Mode::FirstOrder)
+		{
+			const float style = frequency - (frequency - MultiAllPassEngine::FREQUENCY_MIN) * m_params.style;
+			const float frequencyMel = MultiAllPassEngine::FrequencyToMel(frequency);
+			const float styleMel = MultiAllPassEngine::FrequencyToMel(style);
+			const int count = int(m_params.intensity * MultiAllPassEngine::N_ALL_PASS_FO);
+			const float stepMel = (styleMel - frequencyMel) / count;
+
+			FirstOrderState* allPass = &m_firstOrderAllPass[channel * MultiAllPassEngine::N_ALL_PASS_FO];
+
+			for (int i = 0; i < count; i++)
+			{
+				FirstOrderCoefficients coefficients;
+				coefficients.init(m_SampleRate);
+				coefficients.setCoefrequencyParameter(MultiAllPassEngine::MelToFrequency(frequencyMel + i * stepMel));
+				allPass[i].a1 = coefficients.getA1();
+			}
+
+			for (int sample = 0; sample < samples; ++sample)
+			{
+				double inAllPass = channelBuffer[sample];
+
+				for (int i = 0; i < count; i++)
+				{
+					const double tmp = allPass[i].a1 * inAllPass + allPass[i].d;
+					allPass[i].d = inAllPass - allPass[i].a1 * tmp;
+					inAllPass = tmp;
+				}
+
+				channelBuffer[sample] = volume * inAllPass;
+			}
+		}
+		else
+		{
+			const float style = 0.01f + m_params.style * 2.0f;
+			const int count = int(m_params.intensity * MultiAllPassEngine::N_ALL_PASS_SO);
+
+			SecondOrderCoefficients coefficients;
+			coefficients.init(m_SampleRate);
+			coefficients.setCoefrequencyParameter(frequency, style);
+
+			SecondOrderState* allPass = &m_secondOrderAllPass[channel * MultiAllPassEngine::N_ALL_PASS_SO];
+
+			for (int i = 0; i < count; i++)
+			{
+				allPass[i].a0 = coefficients.getA0();
+				allPass[i].a1 = coefficients.getA1();
+			}
+
+			for (int sample = 0; sample < samples; ++sample)
+			{
+				double inAllPass = channelBuffer[sample];
+
+				for (int i = 0; i < count; i++)
+				{
+					auto& s = allPass[i];
+					const double yn = s.a0 * (inAllPass - s.ynz2) + s.a1 * (s.xnz1 - s.ynz1) + s.xnz2;
+
+					s.xnz2 = s.xnz1;
+					s.xnz1 = inAllPass;
+					s.ynz2 = s.ynz1;
+					s.ynz1 = yn;
+
+					inAllPass = yn;
+				}
+
+				channelBuffer[sample] = volume * inAllPass;
+			}
+		}
+	}
+}
+
+//==============================================================================
+MultiAllPassConformance::Block::Block(int channels, int maxSamples)
+	: engineBuffers(channels, std::vector<float>(maxSamples)),
+	  referenceBuffers(channels, std::vector<double>(maxSamples)),
+	  enginePointers(channels),
+	  referencePointers(channels)
+{
+	for (int channel = 0; channel < channels; ++channel)
+	{
+		enginePointers[channel] = engineBuffers[channel].data();
+		referencePointers[channel] = referenceBuffers[channel].data();
+	}
+}
+
+void MultiAllPassConformance::Block::load(const std::vector<std::vector<double>>& inputs, int samples)
+{
+	for (size_t channel = 0; channel < engineBuffers.size(); ++channel)
+	{
+		const double* input = inputs[channel].data();
+
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			engineBuffers[channel][sample] = (float)input[sample];
+			referenceBuffers[channel][sample] = (double)(float)input[sample];
+		}
+	}
+}
+
+double MultiAllPassConformance::Block::maxError(double volume, int samples) const
+{
+	// Normalise by the larger of output gain and block peak, coefficient jumps under automation
+	// can transiently push the ladder far above unity and the error scales with it
+	double scale = pow(10.0, volume / 20.0);
+
+	for (const auto& buffer : referenceBuffers)
+	{
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			scale = std::max(scale, fabs(buffer[sample]));
+		}
+	}
+
+	double maxError = 0.0;
+
+	for (size_t channel = 0; channel < engineBuffers.size(); ++channel)
+	{
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			const double error = fabs((double)engineBuffers[channel][sample] - referenceBuffers[channel][sample]) / scale;
+
+			// NaN never compares greater, so treat it as an infinite error
+			maxError = (error == error) ? std::max(maxError, error) : HUGE_VAL;
+		}
+	}
+
+	return maxError;
+}
+
+//==============================================================================
+void MultiAllPassConformance::record(Report& report, const MultiAllPassEngine::Params& params, int signal, double error, double budget)
+{
+	double& maxError = (params.mode == MultiAllPassEngine::Mode::FirstOrder) ? report.maxErrorFO : report.maxErrorSO;
+	maxError = std::max(maxError, error);
+	report.runs++;
+
+	if (error > budget)
+	{
+		report.failures++;
+
+		// Keep the case furthest over its budget
+		if (report.failedBudget == 0.0 || error / budget >= report.failedError / report.failedBudget)
+		{
+			report.failedParams = params;
+			report.failedSignal = signal;
+			report.failedError = error;
+			report.failedBudget = budget;
+		}
+	}
+}
+
+double MultiAllPassConformance::uniform(std::mt19937& random)
+{
+	return random() / 4294967296.0;
+}
+
+//==============================================================================
+double MultiAllPassConformance::errorBudget(const MultiAllPassEngine::Params& params, double sampleRate, bool automation)
+{
+	if (params.mode == MultiAllPassEngine::Mode::FirstOrder)
+	{
+		return ERROR_BUDGET_FO;
+	}
+
+	if (automation)
+	{
+		return ERROR_BUDGET_SO_AUTOMATION;
+	}
+
+	const double pi = 3.141592653589793;
+	const double w = 2.0 * pi * MultiAllPassEngine::sanitiseParams(params).frequency / sampleRate;
+
+	return ERROR_BUDGET_SO_SENSITIVITY / std::max(fabs(sin(w)), 1.0e-6);
+}
+
+void MultiAllPassConformance::generate(Signal signal, double sampleRate, unsigned int seed, std::vector<double>& out)
+{
+	const int samples = (int)out.size();
+
+	switch (signal)
+	{
+	case Impulse:
+		std::fill(out.begin(), out.end(), 0.0);
+
+		if (samples > 0)
+		{
+			out[0] = 1.0;
+		}
+		break;
+
+	case Sweep:
+	{
+		// Exponential sine sweep from FREQUENCY_MIN to 0.45 * sample rate
+		const double pi = 3.141592653589793;
+		const double f0 = MultiAllPassEngine::FREQUENCY_MIN;
+		const double f1 = 0.45 * sampleRate;
+		const double duration = samples / sampleRate;
+		const double k = log(f1 / f0);
+
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			const double t = sample / sampleRate;
+			out[sample] = 0.5 * sin(2.0 * pi * f0 * duration / k * (exp(t / duration * k) - 1.0));
+		}
+		break;
+	}
+
+	case Noise:
+	default:
+	{
+		std::mt19937 random(seed);
+
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			out[sample] = 2.0 * uniform(random) - 1.0;
+		}
+		break;
+	}
+	}
+}
+
+void MultiAllPassConformance::generateChannels(Signal signal, double sampleRate, unsigned int seed, std::vector<std::vector<double>>& out)
+{
+	if (out.empty())
+	{
+		return;
+	}
+
+	generate(signal, sampleRate, seed, out[0]);
+
+	for (size_t channel = 1; channel < out.size(); ++channel)
+	{
+		auto& buffer = out[channel];
+
+		if (signal == Noise)
+		{
+			generate(Noise, sampleRate, seed + (unsigned int)channel, buffer);
+			continue;
+		}
+
+		const int samples = (int)buffer.size();
+		const int delay = (int)channel * CHANNEL_DELAY;
+		const double polarity = (channel % 2 == 1) ? -1.0 : 1.0;
+
+		for (int sample = 0; sample < samples; ++sample)
+		{
+			buffer[sample] = (sample >= delay && sample - delay < (int)out[0].size()) ? polarity * out[0][sample - delay] : 0.0;
+		}
+	}
+}
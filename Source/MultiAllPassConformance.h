@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+    Double precision reference of the all pass ladder and conformance checks
+    that compare MultiAllPassEngine against it. No JUCE dependency.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "MultiAllPassEngine.h"
+#include "RealtimeAudit.h"
+
+//==============================================================================
+class MultiAllPassReference
+{
+public:
+	MultiAllPassReference();
+
+	void prepare(double sampleRate, int channels);
+	void setParams(const MultiAllPassEngine::Params& params);
+	void process(double* const* channelData, int samples);
+
+private:
+	struct FirstOrderState
+	{
+		double a1 = -1.0;
+		double d = 0.0;
+	};
+
+	struct SecondOrderState
+	{
+		double a0 = 0.0;
+		double a1 = 0.0;
+		double xnz2 = 0.0;
+		double xnz1 = 0.0;
+		double ynz2 = 0.0;
+		double ynz1 = 0.0;
+	};
+
+	MultiAllPassEngine::Params m_params;
+
+	int m_SampleRate = 0;
+	int m_channels = 0;
+
+	std::vector<FirstOrderState> m_firstOrderAllPass;
+	std::vector<SecondOrderState> m_secondOrderAllPass;
+};
+
+//==============================================================================
+class MultiAllPassConformance
+{
+public:
+	enum Signal
+	{
+		Impulse,
+		Sweep,
+		Noise,
+		N_SIGNALS
+	};
+
+	// Max absolute error allowed against the reference, normalised by output gain or block peak.
+	// The float second order recursion loses precision as sin(w) goes to zero, where its poles sit
+	// close to the unit circle, so its steady state budget is ERROR_BUDGET_SO_SENSITIVITY / sin(w).
+	// Automation leaves that error in the ladder state across parameter jumps, fuzz uses a flat
+	// budget for it and leaves steady state accuracy to checkGrid.
+	static constexpr double ERROR_BUDGET_FO = 2.0e-5;
+	static constexpr double ERROR_BUDGET_SO_SENSITIVITY = 1.0e-4;
+	static constexpr double ERROR_BUDGET_SO_AUTOMATION = 5.0e-2;
+
+	struct Report
+	{
+		double maxErrorFO = 0.0;
+		double maxErrorSO = 0.0;
+		int runs = 0;
+		int failures = 0;
+
+		// Worst failing case
+		MultiAllPassEngine::Params failedParams;
+		int failedSignal = -1;
+		double failedError = 0.0;
+		double failedBudget = 0.0;
+
+		// Allocations, locks or system calls inside the engine, see RealtimeAudit
+		int realtimeViolations = 0;
+
+		bool passed() const { return failures == 0 && realtimeViolations == 0; }
+	};
+
+	// Impulse, sine sweep and noise over the full parameter grid of both modes. Engine is any
+	// kernel with the MultiAllPassEngine prepare / setParams / process interface.
+	template <typename Engine = MultiAllPassEngine>
+	static Report checkGrid(double sampleRate, int channels = 2, int samples = 4096);
+
+	// Random parameter automation with odd block sizes, deterministic for a given seed.
+	// Both checks also count real time violations when built with MULTIALLPASS_REALTIME_AUDIT.
+	template <typename Engine = MultiAllPassEngine>
+	static Report fuzz(double sampleRate, unsigned int seed, int iterations = 64, int channels = 2);
+
+	static void generate(Signal signal, double sampleRate, unsigned int seed, std::vector<double>& out);
+
+	// One distinct input per channel, so kernels that share work across channels are caught.
+	// Noise gets a seed per channel, impulse and sweep a per channel delay and alternating polarity.
+	static void generateChannels(Signal signal, double sampleRate, unsigned int seed, std::vector<std::vector<double>>& out);
+	static double errorBudget(const MultiAllPassEngine::Params& params, double sampleRate, bool automation);
+
+private:
+	// Channel buffers for one block, the engine runs in float and the reference in double
+	struct Block
+	{
+		Block(int channels, int maxSamples);
+
+		void load(const std::vector<std::vector<double>>& inputs, int samples);
+		double maxError(double volume, int samples) const;
+
+		std::vector<std::vector<float>> engineBuffers;
+		std::vector<std::vector<double>> referenceBuffers;
+		std::vector<float*> enginePointers;
+		std::vector<double*> referencePointers;
+	};
+
+	// Runs both implementations on one block and returns the max normalised error
+	template <typename Engine>
+	static double compareBlock(Engine& engine, MultiAllPassReference& reference, const MultiAllPassEngine::Params& params, const std::vector<std::vector<double>>& inputs, int samples, Block& block);
+
+	static const int CHANNEL_DELAY = 7;
+
+	static void record(Report& report, const MultiAllPassEngine::Params& params, int signal, double error, double budget);
+	static double uniform(std::mt19937& random);
+};
+
+//==============================================================================
+template <typename Engine>
+double MultiAllPassConformance::compareBlock(Engine& engine, MultiAllPassReference& reference, const MultiAllPassEngine::Params& params, const std::vector<std::vector<double>>& inputs, int samples, Block& block)
+{
+	block.load(inputs, samples);
+
+	{
+		// Audit every kernel, not only those that open their own scope
+		RealtimeAudit::ScopedAudioThread audit;
+
+		engine.setParams(params);
+		engine.process(block.enginePointers.data(), samples);
+	}
+
+	reference.setParams(params);
+	reference.process(block.referencePointers.data(), samples);
+
+	return block.maxError(params.volume, samples);
+}
+
+template <typename Engine>
+MultiAllPassConformance::Report MultiAllPassConformance::checkGrid(double sampleRate, int channels, int samples)
+{
+	static const float frequencies[] = { 20.0f, 50.0f, 100.0f, 200.0f, 500.0f, 1000.0f, 2000.0f, 5000.0f, 10000.0f, 20000.0f };
+	static const float styles[] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+	static const float intensities[] = { 0.0f, 0.01f, 0.25f, 0.5f, 0.75f, 1.0f };
+	static const float volumes[] = { -12.0f, 0.0f, 12.0f };
+	static const MultiAllPassEngine::Mode modes[] = { MultiAllPassEngine::Mode::FirstOrder, MultiAllPassEngine::Mode::SecondOrder };
+
+	Report report;
+	const int violations = RealtimeAudit::getNumViolations();
+
+	std::vector<std::vector<double>> inputs[N_SIGNALS];
+	for (int signal = 0; signal < N_SIGNALS; ++signal)
+	{
+		inputs[signal].assign(channels, std::vector<double>(samples));
+		generateChannels((Signal)signal, sampleRate, 1, inputs[signal]);
+	}
+
+	Block block(channels, samples);
+
+	for (auto mode : modes)
+	for (auto frequency : frequencies)
+	for (auto style : styles)
+	for (auto intensity : intensities)
+	for (int signal = 0; signal < N_SIGNALS; ++signal)
+	{
+		// Volume only scales the output, so sweep it on the impulse alone
+		const int nVolumes = (signal == Impulse) ? 3 : 1;
+
+		for (int v = 0; v < nVolumes; ++v)
+		{
+			MultiAllPassEngine::Params params;
+			params.frequency = frequency;
+			params.style = style;
+			params.intensity = intensity;
+			params.volume = (signal == Impulse) ? volumes[v] : 0.0f;
+			params.mode = mode;
+
+			Engine engine;
+			MultiAllPassReference reference;
+			engine.prepare(sampleRate, samples, channels);
+			reference.prepare(sampleRate, channels);
+
+			const double error = compareBlock(engine, reference, params, inputs[signal], samples, block);
+			record(report, params, signal, error, errorBudget(params, sampleRate, false));
+		}
+	}
+
+	report.realtimeViolations = RealtimeAudit::getNumViolations() - violations;
+
+	return report;
+}
+
+template <typename Engine>
+MultiAllPassConformance::Report MultiAllPassConformance::fuzz(double sampleRate, unsigned int seed, int iterations, int channels)
+{
+	const int maxBlockSize = 1024;
+	const int blocks = 32;
+
+	std::mt19937 random(seed);
+	Report report;
+	const int violations = RealtimeAudit::getNumViolations();
+
+	std::vector<std::vector<double>> inputs(channels);
+	Block block(channels, maxBlockSize);
+
+	for (int iteration = 0; iteration < iterations; ++iteration)
+	{
+		Engine engine;
+		MultiAllPassReference reference;
+		engine.prepare(sampleRate, maxBlockSize, channels);
+		reference.prepare(sampleRate, channels);
+
+		MultiAllPassEngine::Params params;
+
+		for (int b = 0; b < blocks; ++b)
+		{
+			// Automate a random subset of parameters, sometimes none
+			if (uniform(random) < 0.5)
+			{
+				params.frequency = (float)(MultiAllPassEngine::FREQUENCY_MIN * pow((double)MultiAllPassEngine::FREQUENCY_MAX / MultiAllPassEngine::FREQUENCY_MIN, uniform(random)));
+			}
+			if (uniform(random) < 0.5)
+			{
+				params.style = (float)uniform(random);
+			}
+			if (uniform(random) < 0.5)
+			{
+				params.intensity = (float)uniform(random);
+			}
+			if (uniform(random) < 0.3)
+			{
+				params.volume = (float)(-12.0 + 24.0 * uniform(random));
+			}
+			if (uniform(random) < 0.1)
+			{
+				params.mode = (params.mode == MultiAllPassEngine::Mode::FirstOrder) ? MultiAllPassEngine::Mode::SecondOrder : MultiAllPassEngine::Mode::FirstOrder;
+			}
+
+			// Odd block sizes, including single samples and the max block
+			const double r = uniform(random);
+			const int samples = (r < 0.1) ? 1 : (r < 0.2) ? maxBlockSize : 1 + 2 * (int)(uniform(random) * (maxBlockSize / 2 - 1));
+
+			for (auto& input : inputs)
+			{
+				input.resize(samples);
+			}
+			generateChannels(Noise, sampleRate, random(), inputs);
+
+			const double error = compareBlock(engine, reference, params, inputs, samples, block);
+			record(report, params, Noise, error, errorBudget(params, sampleRate, true));
+		}
+	}
+
+	report.realtimeViolations = RealtimeAudit::getNumViolations() - violations;
+
+	return report;
+}
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    Multi all pass DSP engine. No JUCE dependency, so it can be embedded in
+    non-JUCE hosts. See MultiAllPassEngineC.h for the C API.
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "MultiAllPassEngine.h"
+#include "RealtimeAudit.h"
+
+//==============================================================================
+MultiAllPassEngine::MultiAllPassEngine()
+{
+}
+
+bool MultiAllPassEngine::prepare(double sampleRate, int maxBlockSize, int channels)
+{
+	if (!std::isfinite(sampleRate) || sampleRate < 1.0 || sampleRate > (double)MAX_SAMPLE_RATE || maxBlockSize < 0 || channels < 0 || channels > MAX_CHANNELS)
+	{
+		return false;
+	}
+
+	// Build the new state aside, so a failed allocation leaves the engine as it was
+	std::vector<FirstOrderAllPass> firstOrderAllPass((size_t)N_ALL_PASS_FO * (size_t)channels);
+	std::vector<SecondOrderAllPass> secondOrderAllPass((size_t)N_ALL_PASS_SO * (size_t)channels);
+
+	for (auto& allPass : firstOrderAllPass)
+	{
+		allPass.init((int)(sampleRate));
+	}
+
+	for (auto& allPass : secondOrderAllPass)
+	{
+		allPass.init((int)(sampleRate));
+	}
+
+	m_firstOrderAllPass.swap(firstOrderAllPass);
+	m_secondOrderAllPass.swap(secondOrderAllPass);
+
+	m_channels = channels;
+	m_maxBlockSize = maxBlockSize;
+
+	return true;
+}
+
+void MultiAllPassEngine::setParams(const Params& params)
+{
+	m_params = sanitiseParams(params);
+}
+
+MultiAllPassEngine::Params MultiAllPassEngine::sanitiseParams(const Params& params)
+{
+	const Params defaults;
+	Params sanitised = params;
+
+	sanitised.frequency = sanitise(params.frequency, (float)FREQUENCY_MIN, (float)FREQUENCY_MAX, defaults.frequency);
+	sanitised.style = sanitise(params.style, 0.0f, 1.0f, defaults.style);
+	sanitised.volume = std::isfinite(params.volume) ? params.volume : defaults.volume;
+
+	// Intensity sets the number of filters in use, keep it in the allocated range
+	sanitised.intensity = sanitise(params.intensity, 0.0f, 1.0f, defaults.intensity);
+
+	return sanitised;
+}
+
+float MultiAllPassEngine::sanitise(float value, float min, float max, float fallback)
+{
+	if (!std::isfinite(value))
+	{
+		return fallback;
+	}
+
+	return std::min(std::max(value, min), max);
+}
+
+void MultiAllPassEngine::process(float* const* channelData, int samples)
+{
+	RealtimeAudit::ScopedAudioThread audit;
+
+	for (int channel = 0; channel < m_channels; ++channel)
+	{
+		if (m_params.mode == Mode::FirstOrder)
+		{
+			processFirstOrder(channelData[channel], channel, samples);
+		}
+		else
+		{
+			processSecondOrder(channelData[channel], channel, samples);
+		}
+	}
+}
+
+void MultiAllPassEngine::processFirstOrder(float* channelBuffer, int channel, int samples)
+{
+	// Get params
+	const float frequency = m_params.frequency;
+	const float style = frequency - (frequency - FREQUENCY_MIN) * m_params.style;
+	const float volume = DecibelsToGain(m_params.volume);
+
+	FirstOrderAllPass* allPass = &m_firstOrderAllPass[channel * N_ALL_PASS_FO];
+
+	const float frequencyMel = FrequencyToMel(frequency);
+	const float styleMel = FrequencyToMel(style);
+	const int count = int(m_params.intensity * N_ALL_PASS_FO);
+	const float stepMel = (styleMel - frequencyMel) / count;
+
+	for (int i = 0; i < count; i++)
+	{
+		allPass[i].setCoefrequencyParameter(MelToFrequency(frequencyMel + i * stepMel));
+	}
+
+	for (int sample = 0; sample < samples; ++sample)
+	{
+		// Get input
+		const float in = channelBuffer[sample];
+
+		float inAllPass = in;
+
+		for (int i = 0; i < count; i++)
+		{
+			inAllPass = allPass[i].process(inAllPass);
+		}
+
+		// Apply volume, mix and send to output
+		channelBuffer[sample] = volume * inAllPass;
+	}
+}
+
+void MultiAllPassEngine::processSecondOrder(float* channelBuffer, int channel, int samples)
+{
+	// Get params
+	const float frequency = m_params.frequency;
+	const float style = 0.01f + m_params.style * 2.0f;
+	const float volume = DecibelsToGain(m_params.volume);
+
+	SecondOrderAllPass* allPass = &m_secondOrderAllPass[channel * N_ALL_PASS_SO];
+
+	const int count = int(m_params.intensity * N_ALL_PASS_SO);
+
+	for (int i = 0; i < count; i++)
+	{
+		allPass[i].setCoefrequencyParameter(frequency, style);
+	}
+
+	for (int sample = 0; sample < samples; ++sample)
+	{
+		// Get input
+		const float in = channelBuffer[sample];
+
+		float inAllPass = in;
+
+		for (int i = 0; i < count; i++)
+		{
+			inAllPass = allPass[i].process(inAllPass);
+		}
+
+		// Apply volume, mix and send to output
+		channelBuffer[sample] = volume * inAllPass;
+	}
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    Multi all pass DSP engine. No JUCE dependency, so it can be embedded in
+    non-JUCE hosts. See MultiAllPassEngineC.h for the C API.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "AllPass.h"
+
+//==============================================================================
+class MultiAllPassEngine
+{
+public:
+	MultiAllPassEngine();
+
+	static const int N_ALL_PASS_FO = 100;
+	static const int N_ALL_PASS_SO = 50;
+	static const int FREQUENCY_MIN = 20;
+	static const int FREQUENCY_MAX = 20000;
+	static const int MAX_CHANNELS = 256;
+	static const int MAX_SAMPLE_RATE = 1536000;
+
+	enum class Mode
+	{
+		FirstOrder,
+		SecondOrder
+	};
+
+	struct Params
+	{
+		float frequency = 500.0f;	// Hz, FREQUENCY_MIN - FREQUENCY_MAX
+		float style = 0.5f;			// 0 - 1
+		float intensity = 0.5f;		// 0 - 1
+		float volume = 0.0f;		// dB
+		Mode mode = Mode::FirstOrder;
+	};
+
+	// Allocates filter state, call before process and outside of the audio thread. Returns false
+	// and leaves the engine unchanged on invalid arguments, throws std::bad_alloc the same way.
+	bool prepare(double sampleRate, int maxBlockSize, int channels);
+	void setParams(const Params& params);
+
+	// Clamps params to their ranges, non finite values fall back to the defaults
+	static Params sanitiseParams(const Params& params);
+
+	// Processes channels in place, channelData must hold at least getNumChannels() pointers
+	void process(float* const* channelData, int samples);
+
+	int getNumChannels() const { return m_channels; }
+	int getMaxBlockSize() const { return m_maxBlockSize; }
+
+	static inline float FrequencyToMel(float frequency)
+	{
+		return 2595.0f * log10f(1.0f + frequency / 700.0f);
+	}
+	static inline float MelToFrequency(float mel)
+	{
+		return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+	}
+	static inline float DecibelsToGain(float decibels)
+	{
+		return powf(10.0f, decibels * 0.05f);
+	}
+
+private:
+	static float sanitise(float value, float min, float max, float fallback);
+
+	void processFirstOrder(float* channelBuffer, int channel, int samples);
+	void processSecondOrder(float* channelBuffer, int channel, int samples);
+
+	Params m_params;
+
+	int m_channels = 0;
+	int m_maxBlockSize = 0;
+
+	std::vector<FirstOrderAllPass> m_firstOrderAllPass;
+	std::vector<SecondOrderAllPass> m_secondOrderAllPass;
+};
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    C API for MultiAllPassEngine. Audio is processed in place, so host buffers
+    are never copied.
+
+  ==============================================================================
+*/
+
+#include <new>
+
+#include "MultiAllPassEngine.h"
+#include "MultiAllPassEngineC.h"
+
+//==============================================================================
+struct MultiAllPassEngineHandle
+{
+	MultiAllPassEngine engine;
+};
+
+MultiAllPassEngineHandle* multiallpass_create(void)
+{
+	return new (std::nothrow) MultiAllPassEngineHandle();
+}
+
+void multiallpass_destroy(MultiAllPassEngineHandle* engine)
+{
+	delete engine;
+}
+
+int multiallpass_prepare(MultiAllPassEngineHandle* engine, double sampleRate, int maxBlockSize, int channels)
+{
+	if (engine == nullptr)
+	{
+		return 1;
+	}
+
+	// No exception may cross the C boundary
+	try
+	{
+		return engine->engine.prepare(sampleRate, maxBlockSize, channels) ? 0 : 1;
+	}
+	catch (...)
+	{
+		return 1;
+	}
+}
+
+void multiallpass_set_params(MultiAllPassEngineHandle* engine, const MultiAllPassParams* params)
+{
+	if (engine == nullptr || params == nullptr)
+	{
+		return;
+	}
+
+	MultiAllPassEngine::Params engineParams;
+	engineParams.frequency = params->frequency;
+	engineParams.style = params->style;
+	engineParams.intensity = params->intensity;
+	engineParams.volume = params->volume;
+	engineParams.mode = (params->mode == MULTIALLPASS_MODE_SECOND_ORDER) ? MultiAllPassEngine::Mode::SecondOrder : MultiAllPassEngine::Mode::FirstOrder;
+
+	engine->engine.setParams(engineParams);
+}
+
+void multiallpass_process(MultiAllPassEngineHandle* engine, float* const* channelData, int samples)
+{
+	if (engine == nullptr || channelData == nullptr)
+	{
+		return;
+	}
+
+	engine->engine.process(channelData, samples);
+}
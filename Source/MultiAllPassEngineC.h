@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    C API for MultiAllPassEngine. Audio is processed in place, so host buffers
+    are never copied.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MultiAllPassEngineHandle MultiAllPassEngineHandle;
+
+enum
+{
+	MULTIALLPASS_MODE_FIRST_ORDER = 0,
+	MULTIALLPASS_MODE_SECOND_ORDER = 1
+};
+
+typedef struct
+{
+	float frequency;	/* Hz, 20 - 20000 */
+	float style;		/* 0 - 1 */
+	float intensity;	/* 0 - 1 */
+	float volume;		/* dB */
+	int mode;			/* MULTIALLPASS_MODE_* */
+} MultiAllPassParams;
+
+/* A handle is not thread safe, set_params and process must not run at the same time on one
+   handle. Call them from the audio thread, or synchronise them in the host. */
+
+/* Returns NULL on allocation failure */
+MultiAllPassEngineHandle* multiallpass_create(void);
+void multiallpass_destroy(MultiAllPassEngineHandle* engine);
+
+/* Returns 0 on success, non zero on invalid arguments or allocation failure. Channels must be
+   0 - 256. On failure the engine keeps its previous state. */
+int multiallpass_prepare(MultiAllPassEngineHandle* engine, double sampleRate, int maxBlockSize, int channels);
+
+/* Out of range values are clamped, non finite values fall back to the defaults
+   (500 Hz, 0.5, 0.5, 0 dB) */
+void multiallpass_set_params(MultiAllPassEngineHandle* engine, const MultiAllPassParams* params);
+
+void multiallpass_process(MultiAllPassEngineHandle* engine, float* const* channelData, int samples);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,80 +9,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-//==============================================================================
-FirstOrderAllPass::FirstOrderAllPass()
-{
-}
-
-void FirstOrderAllPass::init(int sampleRate)
-{
-	m_SampleRate = sampleRate;
-}
-
-void FirstOrderAllPass::setCoefrequencyParameter(float frequency)
-{
-	if (m_SampleRate == 0)
-	{
-		return;
-	}
-
-	const float tmp = tanf(3.14f * frequency / m_SampleRate);
-	m_a1 = (tmp - 1.0f) / (tmp + 1.0f);
-}
-
-void FirstOrderAllPass::setCoef(float coef)
-{
-	m_a1 = coef;
-}
-
-float FirstOrderAllPass::process(float in)
-{
-	const float tmp = m_a1 * in + m_d;
-	m_d = in - m_a1 * tmp;
-	return tmp;
-}
-
-//==============================================================================
-SecondOrderAllPass::SecondOrderAllPass()
-{
-}
-
-void SecondOrderAllPass::init(int sampleRate)
-{
-	m_SampleRate = sampleRate;
-}
-
-void SecondOrderAllPass::setCoefrequencyParameter(float frequency, float Q)
-{
-	if (m_SampleRate == 0)
-	{
-		return;
-	}
-
-	const float pi = 3.141592653589793f;
-
-	const float w = 2.0f * pi * frequency / m_SampleRate;
-	const float cosw = cos(w);
-	const float alpha = sin(w) * (2.0f * Q);
-
-	const float a2 = 1 + alpha;
-
-	m_a0 = (1.0f - alpha) / a2;
-	m_a1 = (-2.0f * cosw) / a2;
-}
-
-float SecondOrderAllPass::process(float in)
-{
-	const float yn = m_a0 * (in - m_ynz2) + m_a1 * (m_xnz1 - m_ynz1) + m_xnz2;
-	
-	m_xnz2 = m_xnz1;
-	m_xnz1 = in;
-	m_ynz2 = m_ynz1;
-	m_ynz1 = yn;
-	
-	return yn;
-}
-
 //==============================================================================
 
 const std::string MultiAllPassAudioProcessor::paramsNames[] = { "Frequency", "Style", "Intensity", "Volume" };
@@ -178,15 +104,9 @@ void MultiAllPassAudioProcessor::changeProgramName (int index, const juce::Strin
 //==============================================================================
 void MultiAllPassAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-	for (int i = 0; i < N_ALL_PASS_FO * 2; i++)
-	{
-		m_firstOrderAllPass[i].init((int)(sampleRate));
-	}
-
-	for (int i = 0; i < N_ALL_PASS_SO * 2; i++)
-	{
-		m_secondOrderAllPass[i].init((int)(sampleRate));
-	}
+	const bool prepared = m_engine.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+	jassert(prepared);
+	juce::ignoreUnused(prepared);
 }
 
 void MultiAllPassAudioProcessor::releaseResources()
@@ -222,79 +142,16 @@ bool MultiAllPassAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 
 void MultiAllPassAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-	// Buttons
-	const auto button1 = button1Parameter->get();
-	const auto button2 = button2Parameter->get();
-
 	// Get params
-	const auto frequency = frequencyParameter->load();
-	const auto style = (button1) ? (frequency - (frequency - FREQUENCY_MIN) * styleParameter->load()) : (0.01f + styleParameter->load() * 2.0f);
-	const auto intensity = intensityParameter->load();
-	const auto volume = juce::Decibels::decibelsToGain(volumeParameter->load());
-
-	// Mics constants
-	const int channels = getTotalNumOutputChannels();
-	const int samples = buffer.getNumSamples();
-
-	for (int channel = 0; channel < channels; ++channel)
-	{
-		// Channel pointer
-		auto* channelBuffer = buffer.getWritePointer(channel);
-
-		if (button1 == true)
-		{
-			const float frequencyMel = FrequencyToMel(frequency);
-			const float styleMel = FrequencyToMel(style);
-			const int count = int(intensity * N_ALL_PASS_FO);
-			const float stepMel = (styleMel - frequencyMel) / count;
-
-			for (int i = 0; i < count; i++)
-			{
-				m_firstOrderAllPass[channel * N_ALL_PASS_FO + i].setCoefrequencyParameter(MelToFrequency(frequencyMel + i * stepMel));
-			}
-
-			for (int sample = 0; sample < samples; ++sample)
-			{
-				// Get input
-				const float in = channelBuffer[sample];
-
-				float inAllPass = in;
-
-				for (int i = 0; i < count; i++)
-				{
-					inAllPass = m_firstOrderAllPass[channel * N_ALL_PASS_FO + i].process(inAllPass);
-				}
-
-				// Apply volume, mix and send to output
-				channelBuffer[sample] = volume * inAllPass;
-			}
-		}
-		else
-		{
-			const int count = int(intensity * N_ALL_PASS_SO);
-
-			for (int i = 0; i < count; i++)
-			{
-				m_secondOrderAllPass[channel * N_ALL_PASS_SO + i].setCoefrequencyParameter(frequency, style);
-			}
-
-			for (int sample = 0; sample < samples; ++sample)
-			{
-				// Get input
-				const float in = channelBuffer[sample];
-
-				float inAllPass = in;
-
-				for (int i = 0; i < count; i++)
-				{
-					inAllPass = m_secondOrderAllPass[channel * N_ALL_PASS_SO + i].process(inAllPass);
-				}
-
-				// Apply volume, mix and send to output
-				channelBuffer[sample] = volume * inAllPass;
-			}
-		}
-	}
+	MultiAllPassEngine::Params params;
+	params.frequency = frequencyParameter->load();
+	params.style = styleParameter->load();
+	params.intensity = intensityParameter->load();
+	params.volume = volumeParameter->load();
+	params.mode = (button1Parameter->get()) ? MultiAllPassEngine::Mode::FirstOrder : MultiAllPassEngine::Mode::SecondOrder;
+
+	m_engine.setParams(params);
+	m_engine.process(buffer.getArrayOfWritePointers(), buffer.getNumSamples());
 }
 
 //==============================================================================
@@ -0,0 +1,609 @@
+/*
+  ==============================================================================
+
+    Real time safety audit for the audio callback. No JUCE dependency.
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+
+#if MULTIALLPASS_REALTIME_AUDIT && defined(__GLIBC__)
+ #define MULTIALLPASS_REALTIME_AUDIT_HOOKS 1
+#else
+ #define MULTIALLPASS_REALTIME_AUDIT_HOOKS 0
+#endif
+
+#if MULTIALLPASS_REALTIME_AUDIT_HOOKS
+
+// Fortified headers turn some of the hooked calls into inline wrappers
+#undef _FORTIFY_SOURCE
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+
+extern "C"
+{
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* ptr, size_t size);
+	void* __libc_memalign(size_t alignment, size_t size);
+	void __libc_free(void* ptr);
+}
+
+//==============================================================================
+namespace
+{
+	// Initial exec TLS, so touching it never allocates from inside the hooks
+	__thread int auditDepth __attribute__((tls_model("initial-exec"))) = 0;
+	__thread bool inHook __attribute__((tls_model("initial-exec"))) = false;
+
+	std::atomic<int> violations{ 0 };
+	RealtimeAudit::Record records[RealtimeAudit::MAX_RECORDS];
+
+	void record(RealtimeAudit::Violation type, const char* function)
+	{
+		if (auditDepth == 0 || inHook)
+		{
+			return;
+		}
+
+		inHook = true;
+
+		const int index = violations.fetch_add(1);
+		if (index < RealtimeAudit::MAX_RECORDS)
+		{
+			auto& r = records[index];
+			r.type = type;
+			r.function = function;
+			r.frames = backtrace(r.stack, RealtimeAudit::MAX_FRAMES);
+		}
+
+		inHook = false;
+	}
+
+	// Library constructors can reach the hooks before our own static initialisers run
+	template <typename Function>
+	Function next(Function& function, const char* name)
+	{
+		if (function == nullptr)
+		{
+			function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+		}
+
+		return function;
+	}
+
+	// Condition variables carry an old and a new symbol version, plain dlsym returns the old one
+	template <typename Function>
+	Function next(Function& function, const char* name, const char* version)
+	{
+		if (function == nullptr)
+		{
+			function = reinterpret_cast<Function>(dlvsym(RTLD_NEXT, name, version));
+		}
+
+		return next(function, name);
+	}
+
+	using PosixMemalignFunction = int (*)(void**, size_t, size_t);
+	using AlignedAllocFunction = void* (*)(size_t, size_t);
+	using MutexFunction = int (*)(pthread_mutex_t*);
+	using RwlockFunction = int (*)(pthread_rwlock_t*);
+	using SpinFunction = int (*)(pthread_spinlock_t*);
+	using CondWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*);
+	using CondTimedwaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+	using SemWaitFunction = int (*)(sem_t*);
+	using SemTimedwaitFunction = int (*)(sem_t*, const struct timespec*);
+	using ReadFunction = ssize_t (*)(int, void*, size_t);
+	using WriteFunction = ssize_t (*)(int, const void*, size_t);
+	using OpenFunction = int (*)(const char*, int, ...);
+	using CloseFunction = int (*)(int);
+	using FopenFunction = FILE* (*)(const char*, const char*);
+	using MmapFunction = void* (*)(void*, size_t, int, int, int, off_t);
+	using MunmapFunction = int (*)(void*, size_t);
+	using PollFunction = int (*)(struct pollfd*, nfds_t, int);
+	using SelectFunction = int (*)(int, fd_set*, fd_set*, fd_set*, struct timeval*);
+	using SyscallFunction = long (*)(long, ...);
+	using NanosleepFunction = int (*)(const struct timespec*, struct timespec*);
+	using ClockNanosleepFunction = int (*)(clockid_t, int, const struct timespec*, struct timespec*);
+	using UsleepFunction = int (*)(useconds_t);
+	using YieldFunction = int (*)();
+	using VfprintfFunction = int (*)(FILE*, const char*, va_list);
+	using FputsFunction = int (*)(const char*, FILE*);
+	using PutsFunction = int (*)(const char*);
+	using FwriteFunction = size_t (*)(const void*, size_t, size_t, FILE*);
+
+	PosixMemalignFunction realPosixMemalign = nullptr;
+	AlignedAllocFunction realAlignedAlloc = nullptr;
+	MutexFunction realMutexLock = nullptr;
+	MutexFunction realMutexTrylock = nullptr;
+	RwlockFunction realRwlockRdlock = nullptr;
+	RwlockFunction realRwlockWrlock = nullptr;
+	SpinFunction realSpinLock = nullptr;
+	CondWaitFunction realCondWait = nullptr;
+	CondTimedwaitFunction realCondTimedwait = nullptr;
+	SemWaitFunction realSemWait = nullptr;
+	SemTimedwaitFunction realSemTimedwait = nullptr;
+	ReadFunction realRead = nullptr;
+	WriteFunction realWrite = nullptr;
+	OpenFunction realOpen = nullptr;
+	CloseFunction realClose = nullptr;
+	FopenFunction realFopen = nullptr;
+	MmapFunction realMmap = nullptr;
+	MunmapFunction realMunmap = nullptr;
+	PollFunction realPoll = nullptr;
+	SelectFunction realSelect = nullptr;
+	SyscallFunction realSyscall = nullptr;
+	NanosleepFunction realNanosleep = nullptr;
+	ClockNanosleepFunction realClockNanosleep = nullptr;
+	UsleepFunction realUsleep = nullptr;
+	YieldFunction realYield = nullptr;
+	VfprintfFunction realVfprintf = nullptr;
+	FputsFunction realFputs = nullptr;
+	PutsFunction realPuts = nullptr;
+	FwriteFunction realFwrite = nullptr;
+
+	const char* CONDITION_VERSION = "GLIBC_2.3.2";
+
+	// Resolve everything up front, dlsym and the first backtrace may allocate
+	struct Initialiser
+	{
+		Initialiser()
+		{
+			next(realPosixMemalign, "posix_memalign");
+			next(realAlignedAlloc, "aligned_alloc");
+			next(realMutexLock, "pthread_mutex_lock");
+			next(realMutexTrylock, "pthread_mutex_trylock");
+			next(realRwlockRdlock, "pthread_rwlock_rdlock");
+			next(realRwlockWrlock, "pthread_rwlock_wrlock");
+			next(realSpinLock, "pthread_spin_lock");
+			next(realCondWait, "pthread_cond_wait", CONDITION_VERSION);
+			next(realCondTimedwait, "pthread_cond_timedwait", CONDITION_VERSION);
+			next(realSemWait, "sem_wait");
+			next(realSemTimedwait, "sem_timedwait");
+			next(realRead, "read");
+			next(realWrite, "write");
+			next(realOpen, "open");
+			next(realClose, "close");
+			next(realFopen, "fopen");
+			next(realMmap, "mmap");
+			next(realMunmap, "munmap");
+			next(realPoll, "poll");
+			next(realSelect, "select");
+			next(realSyscall, "syscall");
+			next(realNanosleep, "nanosleep");
+			next(realClockNanosleep, "clock_nanosleep");
+			next(realUsleep, "usleep");
+			next(realYield, "sched_yield");
+			next(realVfprintf, "vfprintf");
+			next(realFputs, "fputs");
+			next(realPuts, "puts");
+			next(realFwrite, "fwrite");
+
+			void* stack[1];
+			backtrace(stack, 1);
+		}
+	};
+
+	Initialiser initialiser;
+
+	const char* violationName(RealtimeAudit::Violation type)
+	{
+		switch (type)
+		{
+		case RealtimeAudit::Violation::Allocation:		return "allocation";
+		case RealtimeAudit::Violation::Deallocation:	return "deallocation";
+		case RealtimeAudit::Violation::MutexLock:		return "lock";
+		case RealtimeAudit::Violation::Wait:			return "wait";
+		case RealtimeAudit::Violation::SystemCall:		return "system call";
+		}
+
+		return "unknown";
+	}
+}
+
+//==============================================================================
+extern "C"
+{
+	void* malloc(size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "malloc");
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t count, size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "calloc");
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* ptr, size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "realloc");
+		return __libc_realloc(ptr, size);
+	}
+
+	void* memalign(size_t alignment, size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "memalign");
+		return __libc_memalign(alignment, size);
+	}
+
+	void* aligned_alloc(size_t alignment, size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "aligned_alloc");
+		return next(realAlignedAlloc, "aligned_alloc")(alignment, size);
+	}
+
+	int posix_memalign(void** ptr, size_t alignment, size_t size)
+	{
+		record(RealtimeAudit::Violation::Allocation, "posix_memalign");
+		return next(realPosixMemalign, "posix_memalign")(ptr, alignment, size);
+	}
+
+	void free(void* ptr)
+	{
+		if (ptr != nullptr)
+		{
+			record(RealtimeAudit::Violation::Deallocation, "free");
+		}
+
+		__libc_free(ptr);
+	}
+
+	int pthread_mutex_lock(pthread_mutex_t* mutex)
+	{
+		record(RealtimeAudit::Violation::MutexLock, "pthread_mutex_lock");
+		return next(realMutexLock, "pthread_mutex_lock")(mutex);
+	}
+
+	int pthread_mutex_trylock(pthread_mutex_t* mutex)
+	{
+		record(RealtimeAudit::Violation::MutexLock, "pthread_mutex_trylock");
+		return next(realMutexTrylock, "pthread_mutex_trylock")(mutex);
+	}
+
+	int pthread_rwlock_rdlock(pthread_rwlock_t* lock)
+	{
+		record(RealtimeAudit::Violation::MutexLock, "pthread_rwlock_rdlock");
+		return next(realRwlockRdlock, "pthread_rwlock_rdlock")(lock);
+	}
+
+	int pthread_rwlock_wrlock(pthread_rwlock_t* lock)
+	{
+		record(RealtimeAudit::Violation::MutexLock, "pthread_rwlock_wrlock");
+		return next(realRwlockWrlock, "pthread_rwlock_wrlock")(lock);
+	}
+
+	int pthread_spin_lock(pthread_spinlock_t* lock)
+	{
+		record(RealtimeAudit::Violation::MutexLock, "pthread_spin_lock");
+		return next(realSpinLock, "pthread_spin_lock")(lock);
+	}
+
+	int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+	{
+		record(RealtimeAudit::Violation::Wait, "pthread_cond_wait");
+		return next(realCondWait, "pthread_cond_wait", CONDITION_VERSION)(condition, mutex);
+	}
+
+	int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+	{
+		record(RealtimeAudit::Violation::Wait, "pthread_cond_timedwait");
+		return next(realCondTimedwait, "pthread_cond_timedwait", CONDITION_VERSION)(condition, mutex, time);
+	}
+
+	int sem_wait(sem_t* semaphore)
+	{
+		record(RealtimeAudit::Violation::Wait, "sem_wait");
+		return next(realSemWait, "sem_wait")(semaphore);
+	}
+
+	int sem_timedwait(sem_t* semaphore, const struct timespec* time)
+	{
+		record(RealtimeAudit::Violation::Wait, "sem_timedwait");
+		return next(realSemTimedwait, "sem_timedwait")(semaphore, time);
+	}
+
+	ssize_t read(int fd, void* buffer, size_t count)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "read");
+		return next(realRead, "read")(fd, buffer, count);
+	}
+
+	ssize_t write(int fd, const void* buffer, size_t count)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "write");
+		return next(realWrite, "write")(fd, buffer, count);
+	}
+
+	int open(const char* path, int flags, ...)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "open");
+
+		va_list args;
+		va_start(args, flags);
+		const mode_t mode = (flags & (O_CREAT | O_TMPFILE)) ? va_arg(args, mode_t) : 0;
+		va_end(args);
+
+		return next(realOpen, "open")(path, flags, mode);
+	}
+
+	int close(int fd)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "close");
+		return next(realClose, "close")(fd);
+	}
+
+	FILE* fopen(const char* path, const char* mode)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "fopen");
+		return next(realFopen, "fopen")(path, mode);
+	}
+
+	void* mmap(void* address, size_t length, int protection, int flags, int fd, off_t offset)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "mmap");
+		return next(realMmap, "mmap")(address, length, protection, flags, fd, offset);
+	}
+
+	int munmap(void* address, size_t length)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "munmap");
+		return next(realMunmap, "munmap")(address, length);
+	}
+
+	int poll(struct pollfd* fds, nfds_t count, int timeout)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "poll");
+		return next(realPoll, "poll")(fds, count, timeout);
+	}
+
+	int select(int count, fd_set* readFds, fd_set* writeFds, fd_set* exceptFds, struct timeval* timeout)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "select");
+		return next(realSelect, "select")(count, readFds, writeFds, exceptFds, timeout);
+	}
+
+	// Forwards the six argument registers every Linux system call can use
+	long syscall(long number, ...)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "syscall");
+
+		va_list args;
+		va_start(args, number);
+		long a[6];
+		for (auto& arg : a)
+		{
+			arg = va_arg(args, long);
+		}
+		va_end(args);
+
+		return next(realSyscall, "syscall")(number, a[0], a[1], a[2], a[3], a[4], a[5]);
+	}
+
+	int nanosleep(const struct timespec* duration, struct timespec* remaining)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "nanosleep");
+		return next(realNanosleep, "nanosleep")(duration, remaining);
+	}
+
+	int clock_nanosleep(clockid_t clock, int flags, const struct timespec* duration, struct timespec* remaining)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "clock_nanosleep");
+		return next(realClockNanosleep, "clock_nanosleep")(clock, flags, duration, remaining);
+	}
+
+	int usleep(useconds_t usec)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "usleep");
+		return next(realUsleep, "usleep")(usec);
+	}
+
+	int sched_yield()
+	{
+		record(RealtimeAudit::Violation::SystemCall, "sched_yield");
+		return next(realYield, "sched_yield")();
+	}
+
+	// glibc writes stdio output through internal calls that skip the write hook
+	int vfprintf(FILE* stream, const char* format, va_list args)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "vfprintf");
+		return next(realVfprintf, "vfprintf")(stream, format, args);
+	}
+
+	int vprintf(const char* format, va_list args)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "vprintf");
+		return next(realVfprintf, "vfprintf")(stdout, format, args);
+	}
+
+	int fprintf(FILE* stream, const char* format, ...)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "fprintf");
+
+		va_list args;
+		va_start(args, format);
+		const int result = next(realVfprintf, "vfprintf")(stream, format, args);
+		va_end(args);
+
+		return result;
+	}
+
+	int printf(const char* format, ...)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "printf");
+
+		va_list args;
+		va_start(args, format);
+		const int result = next(realVfprintf, "vfprintf")(stdout, format, args);
+		va_end(args);
+
+		return result;
+	}
+
+	int fputs(const char* string, FILE* stream)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "fputs");
+		return next(realFputs, "fputs")(string, stream);
+	}
+
+	int puts(const char* string)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "puts");
+		return next(realPuts, "puts")(string);
+	}
+
+	size_t fwrite(const void* data, size_t size, size_t count, FILE* stream)
+	{
+		record(RealtimeAudit::Violation::SystemCall, "fwrite");
+		return next(realFwrite, "fwrite")(data, size, count, stream);
+	}
+}
+
+//==============================================================================
+RealtimeAudit::ScopedAudioThread::ScopedAudioThread()
+{
+	auditDepth++;
+}
+
+RealtimeAudit::ScopedAudioThread::~ScopedAudioThread()
+{
+	auditDepth--;
+}
+
+bool RealtimeAudit::isEnabled()
+{
+	return true;
+}
+
+bool RealtimeAudit::checkHooks()
+{
+	// Called through volatile pointers so the compiler cannot elide the pair
+	void* (*volatile allocate)(size_t) = malloc;
+	void (*volatile release)(void*) = free;
+
+	const int before = violations.load();
+
+	{
+		ScopedAudioThread audit;
+		release(allocate(16));
+	}
+
+	const bool detected = violations.load() - before == 2;
+	violations.store(before);
+
+	return detected;
+}
+
+int RealtimeAudit::getNumViolations()
+{
+	return violations.load();
+}
+
+int RealtimeAudit::getNumRecords()
+{
+	const int count = violations.load();
+	return (count < MAX_RECORDS) ? count : MAX_RECORDS;
+}
+
+const RealtimeAudit::Record& RealtimeAudit::getRecord(int index)
+{
+	assert(index >= 0 && index < getNumRecords());
+	return records[index];
+}
+
+void RealtimeAudit::reset()
+{
+	violations.store(0);
+}
+
+std::string RealtimeAudit::describe()
+{
+	std::string report = std::to_string(getNumViolations()) + " real time violation(s)\n";
+
+	for (int i = 0; i < getNumRecords(); i++)
+	{
+		const auto& r = records[i];
+		report += "#" + std::to_string(i) + " " + violationName(r.type) + " in " + r.function + "\n";
+
+		char** symbols = backtrace_symbols(r.stack, r.frames);
+		for (int frame = 0; frame < r.frames; frame++)
+		{
+			report += "    ";
+			report += (symbols != nullptr) ? symbols[frame] : "?";
+			report += "\n";
+		}
+
+		free(symbols);
+	}
+
+	return report;
+}
+
+#else
+
+//==============================================================================
+#if MULTIALLPASS_REALTIME_AUDIT
+RealtimeAudit::ScopedAudioThread::ScopedAudioThread()
+{
+}
+
+RealtimeAudit::ScopedAudioThread::~ScopedAudioThread()
+{
+}
+#endif
+
+bool RealtimeAudit::isEnabled()
+{
+	return false;
+}
+
+bool RealtimeAudit::checkHooks()
+{
+	return false;
+}
+
+int RealtimeAudit::getNumViolations()
+{
+	return 0;
+}
+
+int RealtimeAudit::getNumRecords()
+{
+	return 0;
+}
+
+const RealtimeAudit::Record& RealtimeAudit::getRecord(int /*index*/)
+{
+	static const Record empty = {};
+	return empty;
+}
+
+void RealtimeAudit::reset()
+{
+}
+
+std::string RealtimeAudit::describe()
+{
+	return "Real time audit is not available in this build\n";
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    Real time safety audit for the audio callback. No JUCE dependency.
+
+    Build with MULTIALLPASS_REALTIME_AUDIT=1 to record allocations, mutex locks
+    and blocking system calls made inside a ScopedAudioThread, with stack
+    traces. Hooks are installed by symbol interposition on glibc, so they see
+    calls from the executable they are linked into (tests, benchmarks,
+    standalone builds). Elsewhere they are a no-op.
+
+    Hooked calls:
+      allocation   malloc, calloc, realloc, free, memalign, aligned_alloc,
+                   posix_memalign (and so operator new / delete)
+      locks        pthread_mutex_lock / trylock, pthread_rwlock_rdlock /
+                   wrlock, pthread_spin_lock
+      waits        pthread_cond_wait / timedwait, sem_wait / timedwait
+      system calls read, write, open, close, fopen, mmap, munmap, poll,
+                   select, syscall, nanosleep, clock_nanosleep, usleep,
+                   sched_yield, printf, fprintf, vprintf, vfprintf, puts,
+                   fputs, fwrite
+
+    Anything else is not seen, including glibc internal paths that bypass the
+    public symbols (stdio buffering, internal locks, inline futex calls),
+    *64 variants such as open64, and direct system call instructions.
+
+    RealtimeAudit.cpp replaces libc symbols and must only be linked into
+    executables, never into the plugin or another shared library. With the
+    flag off ScopedAudioThread is inline and needs no definitions, which is
+    how the plugin is built.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <string>
+
+#ifndef MULTIALLPASS_REALTIME_AUDIT
+ #define MULTIALLPASS_REALTIME_AUDIT 0
+#endif
+
+//==============================================================================
+class RealtimeAudit
+{
+public:
+	static const int MAX_RECORDS = 64;
+	static const int MAX_FRAMES = 32;
+
+	enum class Violation
+	{
+		Allocation,
+		Deallocation,
+		MutexLock,
+		Wait,
+		SystemCall
+	};
+
+	struct Record
+	{
+		Violation type;
+		const char* function;
+		int frames;
+		void* stack[MAX_FRAMES];
+	};
+
+	// Marks the current thread as an audio thread for the lifetime of the object, may be nested
+	class ScopedAudioThread
+	{
+	public:
+#if MULTIALLPASS_REALTIME_AUDIT
+		ScopedAudioThread();
+		~ScopedAudioThread();
+#else
+		ScopedAudioThread() {}
+		~ScopedAudioThread() {}
+#endif
+		ScopedAudioThread(const ScopedAudioThread&) = delete;
+		ScopedAudioThread& operator=(const ScopedAudioThread&) = delete;
+	};
+
+	// True when the audit is compiled in and the hooks are available on this platform
+	static bool isEnabled();
+
+	// Makes a deliberate allocation inside a ScopedAudioThread and checks it is caught, so a
+	// silently inactive audit cannot pass a test. Leaves the violation count unchanged.
+	static bool checkHooks();
+
+	// Total violations since start or the last reset, only the first MAX_RECORDS keep a stack trace
+	static int getNumViolations();
+	static int getNumRecords();
+	static const Record& getRecord(int index);	// index < getNumRecords()
+	static void reset();
+
+	// Human readable report with symbolised stack traces, allocates so call it off the audio thread
+	static std::string describe();
+};
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    Headless benchmark, a timed parameter sweep over MultiAllPassEngine::process.
+
+    Usage: MultiAllPassBenchmark [seconds]
+    Processes the given seconds of stereo audio at 48 kHz (default 1) per mode,
+    intensity and block size, sweeping frequency every block. Prints time per
+    sample and the real time factor. In builds with MULTIALLPASS_REALTIME_AUDIT
+    every block runs under the audit, and the benchmark returns non zero on any
+    violation. Timing never fails the run.
+
+  ==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "MultiAllPassEngine.h"
+#include "RealtimeAudit.h"
+
+//==============================================================================
+namespace
+{
+	const double SAMPLE_RATE = 48000.0;
+	const int CHANNELS = 2;
+
+	const float INTENSITIES[] = { 0.25f, 0.5f, 1.0f };
+	const int BLOCK_SIZES[] = { 32, 256, 1024 };
+
+	// Returns processing time in seconds per sample and channel
+	double run(MultiAllPassEngine::Mode mode, float intensity, int blockSize, double seconds)
+	{
+		MultiAllPassEngine engine;
+		engine.prepare(SAMPLE_RATE, blockSize, CHANNELS);
+
+		std::vector<std::vector<float>> buffers(CHANNELS, std::vector<float>(blockSize));
+		std::vector<float*> pointers(CHANNELS);
+		for (int channel = 0; channel < CHANNELS; ++channel)
+		{
+			pointers[channel] = buffers[channel].data();
+		}
+
+		const int blocks = std::max(1, (int)(seconds * SAMPLE_RATE / blockSize));
+		const double sweep = log((double)MultiAllPassEngine::FREQUENCY_MAX / MultiAllPassEngine::FREQUENCY_MIN);
+
+		MultiAllPassEngine::Params params;
+		params.mode = mode;
+		params.intensity = intensity;
+
+		unsigned int noise = 1;
+		double elapsed = 0.0;
+
+		for (int block = 0; block < blocks; ++block)
+		{
+			for (auto& buffer : buffers)
+			{
+				for (auto& sample : buffer)
+				{
+					noise = noise * 1664525u + 1013904223u;
+					sample = (float)(noise >> 8) / 8388608.0f - 1.0f;
+				}
+			}
+
+			// Log frequency sweep across the run, so every block recomputes coefficients
+			params.frequency = (float)(MultiAllPassEngine::FREQUENCY_MIN * exp(sweep * block / blocks));
+
+			const auto start = std::chrono::steady_clock::now();
+			{
+				RealtimeAudit::ScopedAudioThread audit;
+
+				engine.setParams(params);
+				engine.process(pointers.data(), blockSize);
+			}
+			elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		return elapsed / ((double)blocks * blockSize * CHANNELS);
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	const double seconds = (argc > 1) ? atof(argv[1]) : 1.0;
+
+	bool passed = true;
+
+	if (RealtimeAudit::isEnabled())
+	{
+		if (!RealtimeAudit::checkHooks())
+		{
+			printf("Real time audit hooks are not active\n");
+			passed = false;
+		}
+	}
+	else
+	{
+		printf("Real time audit is not available in this build\n");
+	}
+
+	printf("%-12s %9s %6s %12s %10s %10s\n", "mode", "intensity", "block", "ns/sample", "x realtime", "violations");
+
+	for (auto mode : { MultiAllPassEngine::Mode::FirstOrder, MultiAllPassEngine::Mode::SecondOrder })
+	for (auto intensity : INTENSITIES)
+	for (auto blockSize : BLOCK_SIZES)
+	{
+		const int violations = RealtimeAudit::getNumViolations();
+		const double perSample = run(mode, intensity, blockSize, seconds);
+
+		printf("%-12s %9.2f %6d %12.2f %10.1f %10d\n",
+			(mode == MultiAllPassEngine::Mode::FirstOrder) ? "first order" : "second order",
+			intensity, blockSize, perSample * 1.0e9, 1.0 / (perSample * CHANNELS * SAMPLE_RATE),
+			RealtimeAudit::getNumViolations() - violations);
+	}
+
+	if (RealtimeAudit::getNumViolations() > 0)
+	{
+		printf("%s", RealtimeAudit::describe().c_str());
+		passed = false;
+	}
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	return passed ? 0 : 1;
+}
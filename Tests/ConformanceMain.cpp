@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    Conformance test, checks each engine kernel against MultiAllPassReference.
+
+    Usage: MultiAllPassConformance [sampleRate]
+    Runs 44.1, 48 and 96 kHz when no sample rate is given. Returns non zero
+    when any check exceeds its error budget or, in builds with
+    MULTIALLPASS_REALTIME_AUDIT, when a kernel allocates, locks or makes a
+    system call while processing.
+
+  ==============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "MultiAllPassConformance.h"
+#include "RealtimeAudit.h"
+
+//==============================================================================
+namespace
+{
+	const unsigned int FUZZ_SEEDS[] = { 1, 2, 1234 };
+
+	const char* signalName(int signal)
+	{
+		switch (signal)
+		{
+		case MultiAllPassConformance::Impulse:	return "impulse";
+		case MultiAllPassConformance::Sweep:	return "sweep";
+		case MultiAllPassConformance::Noise:	return "noise";
+		}
+
+		return "-";
+	}
+
+	bool print(const char* kernel, const char* check, double sampleRate, const MultiAllPassConformance::Report& report)
+	{
+		printf("%-20s %-10s %6.0f Hz  runs %5d  failures %4d  max error FO %.3g  SO %.3g  real time violations %d\n",
+			kernel, check, sampleRate, report.runs, report.failures,
+			report.maxErrorFO, report.maxErrorSO, report.realtimeViolations);
+
+		if (report.failures > 0)
+		{
+			const auto& params = report.failedParams;
+			printf("    worst: %s, %s, frequency %g, style %g, intensity %g, volume %g, error %.3g, budget %.3g\n",
+				(params.mode == MultiAllPassEngine::Mode::FirstOrder) ? "first order" : "second order",
+				signalName(report.failedSignal), params.frequency, params.style, params.intensity, params.volume, report.failedError, report.failedBudget);
+		}
+
+		return report.passed();
+	}
+
+	template <typename Engine>
+	bool check(const char* kernel, double sampleRate)
+	{
+		bool passed = print(kernel, "grid", sampleRate, MultiAllPassConformance::checkGrid<Engine>(sampleRate));
+
+		for (auto seed : FUZZ_SEEDS)
+		{
+			char name[32];
+			snprintf(name, sizeof(name), "fuzz %u", seed);
+			passed = print(kernel, name, sampleRate, MultiAllPassConformance::fuzz<Engine>(sampleRate, seed)) && passed;
+		}
+
+		return passed;
+	}
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+	std::vector<double> sampleRates = { 44100.0, 48000.0, 96000.0 };
+
+	if (argc > 1)
+	{
+		sampleRates = { atof(argv[1]) };
+	}
+
+	bool passed = true;
+
+	if (RealtimeAudit::isEnabled())
+	{
+		if (!RealtimeAudit::checkHooks())
+		{
+			printf("Real time audit hooks are not active\n");
+			passed = false;
+		}
+	}
+	else
+	{
+		printf("Real time audit is not available in this build\n");
+	}
+
+	for (auto sampleRate : sampleRates)
+	{
+		// Add optimised kernels here so they are checked alongside the shipping engine
+		passed = check<MultiAllPassEngine>("MultiAllPassEngine", sampleRate) && passed;
+	}
+
+	if (RealtimeAudit::getNumViolations() > 0)
+	{
+		printf("%s", RealtimeAudit::describe().c_str());
+	}
+
+	printf("%s\n", passed ? "PASSED" : "FAILED");
+
+	return passed ? 0 : 1;
+}